@@ -0,0 +1,140 @@
+/*$$FILE$$*/
+/*$$VERSION$$*/
+/*$$DATE$$*/
+/*$$LICENSE$$*/
+
+
+/*!
+** \file BcpSorter.h
+**
+** \brief Header file for BcpSorter class.
+*/
+
+
+#ifndef BCPSORTER_H
+#define BCPSORTER_H
+
+
+#include <string>
+#include <vector>
+#include <istream>
+#include <ostream>
+
+#include "SchemaMap.h"
+
+
+/**
+**  \class BcpSorter
+**
+**  \brief External merge sorter for BCP data files.
+**
+**  This class sorts the rows of a BCP data file by a set of key columns,
+**  using a bounded amount of memory. Rows are read into memory until the
+**  memory limit is reached, sorted and spilled to temporary run files,
+**  which are then merged (in several passes, if the number of runs exceeds
+**  the maximum merge fan-in) into the sorted file. Sorting is stable, so
+**  rows with equal keys retain their original relative order. Data split
+**  into several part files is sorted as one input, and written back into
+**  the same parts, each with its original number of rows.
+*/
+class BcpSorter
+{
+  public:
+    static const unsigned long DEFAULT_MAX_MEMORY = 256 * 1024 * 1024;
+    static const unsigned int DEFAULT_MAX_FAN_IN = 64;
+
+    BcpSorter(const std::string& fieldSeparator,
+      const std::string& rowSeparator, const std::string& stringDelimiter,
+      const std::vector<unsigned int>& keyColumns,
+      const std::vector<eTypeCode>& keyTypes,
+      const unsigned long maxMemory = DEFAULT_MAX_MEMORY,
+      const unsigned int maxFanIn = DEFAULT_MAX_FAN_IN);
+    ~BcpSorter();
+
+    void Sort(const std::string& fileName);
+    void Sort(const std::vector<std::string>& fileNames);
+
+  private:
+    struct KeyField
+    {
+        std::string::size_type start;
+        std::string::size_type length;
+        double number;
+        bool isNumber;
+        bool isNull;
+    };
+
+    struct Record
+    {
+        std::string data;
+        std::vector<KeyField> keys;
+    };
+
+    class RecordLess;
+    friend class RecordLess;
+
+    class RecordLess
+    {
+      public:
+        RecordLess(const BcpSorter& sorter) : _sorter(sorter) {}
+        bool operator()(const Record* first, const Record* second) const
+        {
+            return(_sorter._Compare(*first, *second) < 0);
+        }
+
+      private:
+        const BcpSorter& _sorter;
+    };
+
+    class RunGreater;
+    friend class RunGreater;
+
+    class RunGreater
+    {
+      public:
+        RunGreater(const BcpSorter& sorter,
+          const std::vector<Record*>& heads) : _sorter(sorter),
+          _heads(heads) {}
+        bool operator()(const unsigned int first,
+          const unsigned int second) const
+        {
+            int cmp = _sorter._Compare(*_heads[first], *_heads[second]);
+            if (cmp != 0)
+                return(cmp > 0);
+
+            // Equal keys: earlier run wins, which keeps the sort stable
+            return(first > second);
+        }
+
+      private:
+        const BcpSorter& _sorter;
+        const std::vector<Record*>& _heads;
+    };
+
+    std::string _fieldSeparator;
+    std::string _rowSeparator;
+    std::string _stringDelimiter;
+
+    std::vector<unsigned int> _keyColumns;
+    std::vector<eTypeCode> _keyTypes;
+
+    unsigned long _maxMemory;
+    unsigned int _maxFanIn;
+
+    bool _ReadRecord(std::istream& in, std::string& data);
+    void _WriteRecord(std::ostream& out, const std::string& data);
+
+    void _MakeKeys(Record& record);
+    int _Compare(const Record& first, const Record& second) const;
+
+    void _WriteRun(std::vector<Record*>& records, const std::string& runName);
+    void _Merge(const std::vector<std::string>& runNames,
+      const std::string& outName);
+    void _Split(const std::string& sortedName,
+      const std::vector<std::string>& fileNames,
+      const std::vector<unsigned long>& numRows);
+
+    static void _FreeRecords(std::vector<Record*>& records);
+};
+
+#endif
@@ -0,0 +1,53 @@
+/*$$FILE$$*/
+/*$$VERSION$$*/
+/*$$DATE$$*/
+/*$$LICENSE$$*/
+
+
+/*!
+** \file CifBlockReader.h
+**
+** \brief Header file for CifBlockReader class.
+*/
+
+
+#ifndef CIFBLOCKREADER_H
+#define CIFBLOCKREADER_H
+
+
+#include <string>
+#include <fstream>
+
+
+/**
+**  \class CifBlockReader
+**
+**  \brief Sequential reader of data blocks of an ASCII CIF file.
+**
+**  This class reads an ASCII CIF file one data block at a time, without
+**  parsing it. A data block starts at a line that begins with "data_" and
+**  that is not inside a semicolon delimited text field, and ends at the
+**  start of the next data block or at the end of the file. Text before the
+**  first data block is ignored. Only one data block is held in memory at a
+**  time.
+*/
+class CifBlockReader
+{
+  public:
+    CifBlockReader(const std::string& fileName);
+    ~CifBlockReader();
+
+    bool GetNextBlock(std::string& blockText);
+
+  private:
+    std::string _fileName;
+    std::ifstream _in;
+
+    // First line of the next data block, if already read
+    std::string _nextLine;
+    bool _haveNextLine;
+
+    static bool _IsBlockStart(const std::string& line);
+};
+
+#endif
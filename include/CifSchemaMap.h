@@ -16,15 +16,21 @@
 
 
 #include <string>
+#include <deque>
+#include <map>
 #include <ostream>
 #include <fstream>
+#include <sstream>
 
 #include "CifFile.h"
 #include "SchemaMap.h"
 #include "Db.h"
 #include "DbOutput.h"
+#include "LoaderThreads.h"
 
 
+class ParseCache;
+
 
 /**
 **  \class DbOracle
@@ -57,6 +63,11 @@ class DbOracle : public Db
     void WriteTableIndex(std::ostream& io, const string& tableNameDb,
       const vector<string>& indexList, 
       const vector<string>& indexListTypes=vector<string>());
+    void WriteCreateIndex(std::ostream& io, const string& tableNameDb,
+      const vector<string>& indexList,
+      const vector<string>& indexListTypes=vector<string>());
+    void WriteDropIndex(std::ostream& io, const string& tableNameDb);
+    bool IsParallelIndexSupported();
 
     void WriteNewLine(std::ostream& io, bool special = false);
 };
@@ -96,6 +107,11 @@ class DbDb2 : public Db
     void WriteTableIndex(std::ostream& io, const string& tableNameDb,
       const vector<string>& indexList,
       const vector<string>& indexListTypes=vector<string>());
+    void WriteCreateIndex(std::ostream& io, const string& tableNameDb,
+      const vector<string>& indexList,
+      const vector<string>& indexListTypes=vector<string>());
+    void WriteDropIndex(std::ostream& io, const string& tableNameDb);
+
     void WriteBcpDoubleQuotes(std::ostream& io);
 };
 
@@ -129,6 +145,11 @@ class DbMySql : public Db
     void WriteTableIndex(std::ostream& io, const string& tableNameDb,
       const vector<string>& indexList,
       const vector<string>& indexListTypes=vector<string>());
+    void WriteCreateIndex(std::ostream& io, const string& tableNameDb,
+      const vector<string>& indexList,
+      const vector<string>& indexListTypes=vector<string>());
+    void WriteDropIndex(std::ostream& io, const string& tableNameDb);
+    bool IsParallelIndexSupported();
 
     void WriteNull(std::ostream& io, const int iNull,
       const unsigned int curr, const unsigned int attSize);
@@ -171,6 +192,11 @@ class DbSybase : public Db
     void WriteTableIndex(std::ostream& io, const string& tableNameDb,
       const vector<string>& indexList,
       const vector<string>& indexListTypes=vector<string>());
+    void WriteCreateIndex(std::ostream& io, const string& tableNameDb,
+      const vector<string>& indexList,
+      const vector<string>& indexListTypes=vector<string>());
+    void WriteDropIndex(std::ostream& io, const string& tableNameDb);
+    bool IsParallelIndexSupported();
 
     void GetDateAndTime(string& dateAndTime);
 
@@ -196,6 +222,11 @@ class BcpOutput : public DbOutput
 
     void WriteDataLoadingScripts(const string& path = std::string());
     void WriteData(Block& block, const string& path = std::string());
+    void WriteDataPart(Block& block, const string& path = std::string());
+    void SortData(const string& path = std::string(),
+      const unsigned long maxMemory = 0);
+    void GetDataFileNames(vector<string>& fileNames,
+      const string& path = std::string());
 
   private:
     static const string _DATA_DELETE_FILE;
@@ -205,6 +236,9 @@ class BcpOutput : public DbOutput
 
     void WriteDelete(std::ostream& io);
 
+    void _GetDataFileName(string& tName, const string& tableName,
+      const string& workDir);
+
     void WriteEmptyString(std::ostream& io);
 
     void WriteSpecialDateChar(std::ostream& io, const char& specDateChar);
@@ -229,6 +263,10 @@ class SqlOutput : public DbOutput
     void WriteSchema(const string& path = std::string());
     void WriteDataLoadingScripts(const string& path = std::string());
     void WriteData(Block& block, const string& path = std::string());
+    void WriteDataPart(Block& block, const string& path = std::string());
+    void DiscardDataParts();
+    void GetDataFileNames(vector<string>& fileNames,
+      const string& path = std::string());
 
   protected:
     void WriteEmptyNumeric(std::ostream& io);
@@ -242,6 +280,7 @@ class SqlOutput : public DbOutput
     static const string _SCHEMA_LOADING_SCRIPT;
     static const string _SCHEMA_DELETE_FILE;
     static const string _DATA_FILE;
+    static const string _DATA_PART_FILE_EXT;
 
     void WriteSqlScriptSchemaInfo(std::ostream& io);
     void WriteDataLoadingScript(const string& path);
@@ -417,14 +456,216 @@ class DbLoader
     */
     void SetFirstDataBlock();
 
+    /**
+    **  Enables the block-streaming mode of ASCII CIF file conversion, in
+    **  which the file is read and parsed one data block at a time, instead
+    **  of parsing the whole file before converting it. Each data block is
+    **  converted as soon as it is parsed and is then released, so that only
+    **  a few data blocks are in memory at a time. Data blocks are converted
+    **  concurrently by the specified number of threads, and their data is
+    **  written in the data block order. For outputs that are appended to
+    **  (BCP and SQL), the rows are written out every 100 data blocks, so that
+    **  the memory use does not depend on the size of the file. The deletion
+    **  of the old data is written once, after the last data block, so the
+    **  generated files are the same as without block-streaming. SQL rows are
+    **  kept in temporary "<table>.sql.part" files until then.
+    **
+    **  \param[in] numThreads - indicates the number of data block
+    **    conversion threads. If 0, block-streaming mode is disabled. If 1,
+    **    data blocks are streamed and converted by the calling thread.
+    **
+    **  \return None
+    **
+    **  \pre None
+    **
+    **  \post None
+    **
+    **  \exception: None
+    */
+    void SetStreamBlocks(const unsigned int numThreads);
+
+    /**
+    **  Sets the number of threads that concurrently map the tables of a
+    **  data block. The tables are first dealt to the threads, starting with
+    **  the tables that have the most source rows, and a thread that runs
+    **  out of tables takes the remaining tables of other threads. Mapped
+    **  tables, and their log and error output, are written in the schema
+    **  order, so that the result does not depend on the number of threads.
+    **
+    **  \param[in] numThreads - indicates the number of table mapping
+    **    threads. If 0 or 1, tables are mapped one at a time.
+    **
+    **  \return None
+    **
+    **  \pre None
+    **
+    **  \post None
+    **
+    **  \exception: None
+    */
+    void SetTableThreads(const unsigned int numThreads);
+
+    /**
+    **  Enables the on-disk parse cache of ASCII CIF files. Parsed files are
+    **  serialized into the cache directory and, when the same file, with
+    **  unchanged size and modification time, is converted again with the
+    **  same categories skipped, it is read from the cache instead of being
+    **  parsed. Files whose parsing produces diagnostics are not cached. The
+    **  cache is not used in the block-streaming mode.
+    **
+    **  \param[in] cacheDir - indicates the cache directory. It is created
+    **    if it does not exist.
+    **  \param[in] maxSize - indicates the maximum total size, in bytes, of
+    **    the cached files. When exceeded, the least recently used files are
+    **    removed. If 0, the default of 1 GB is used.
+    **
+    **  \return None
+    **
+    **  \pre None
+    **
+    **  \post None
+    **
+    **  \exception: runtime_error - if the cache directory cannot be created
+    */
+    void SetParseCache(const std::string& cacheDir,
+      const unsigned long maxSize = 0);
+
 
 #ifdef DB_HASH_ID
     void SetHashMode(int mode);
 #endif
 
   private:
+    // Scratch containers for the transient data of one block mapping. They
+    // are reused for all tables, attributes and rows of the block mapped by
+    // one thread, so that their storage is allocated once per block (and
+    // not once per table, attribute or row), and released in one shot when
+    // the block is done.
+    struct BlockScratch
+    {
+        // Mapped attribute columns of the table being mapped
+        vector<vector<string> > dMap;
+
+        // Table row being added
+        vector<string> row;
+
+        // Search and function results
+        vector<string> r;
+        vector<string> r1;
+        vector<string> tRes;
+        vector<unsigned int> is;
+
+        // Search condition columns and values
+        vector<string> cndCol;
+        vector<string> cndVal;
+
+        // Character buffer for in-place name conversion
+        vector<char> name;
+    };
+
+    // Target table of a block, prepared by _PrepareTable() and mapped by
+    // _MapTable()
+    struct TableTask
+    {
+        unsigned int tableI;
+        string tableName;
+
+        // Target table and its attributes
+        ISTable* t;
+        vector<AttrInfo> aI;
+        unsigned int nCols;
+        vector<vector<string> > mappedAttrInfo;
+
+        // Source table of each mapped attribute
+        vector<ISTable*> sources;
+
+        // Lock of each source table, NULL if tables are not mapped
+        // concurrently
+        vector<Mutex*> sourceMutexes;
+
+        // Estimated mapping cost, as the number of source table rows
+        unsigned long cost;
+
+        bool ready;
+        bool updated;
+
+        // Log and error output of the table mapping
+        std::ostream* logP;
+        std::ostream* errP;
+        std::ostringstream logBuf;
+        std::ostringstream errBuf;
+
+        // Error message, if the mapping failed
+        string error;
+
+        TableTask() : tableI(0), t(NULL), nCols(0), cost(0), ready(false),
+          updated(false), logP(NULL), errP(NULL) {}
+    };
+
+    // Tables of one table mapping worker
+    struct TableQueue
+    {
+        Mutex mutex;
+        std::deque<TableTask*> tasks;
+    };
+
+    // Table mapping workers of a block
+    struct TableWorkers
+    {
+        DbLoader* loaderP;
+        string blockName;
+        vector<TableQueue*> queues;
+    };
+
+    struct TableWorker
+    {
+        TableWorkers* workersP;
+        unsigned int workerI;
+    };
+
+    // Data block converted by a worker thread in the block-streaming mode
+    struct BlockTask
+    {
+        unsigned int blockI;
+        string blockName;
+
+        CifFile* readFileP;
+        CifFile* writeFileP;
+
+        // Log and error output of the block conversion
+        std::ostringstream log;
+        std::ostringstream err;
+
+        // Error message, if the conversion failed
+        string error;
+
+        bool done;
+
+        BlockTask() : blockI(0), readFileP(NULL), writeFileP(NULL),
+          done(false) {}
+        ~BlockTask() { delete (readFileP); delete (writeFileP); }
+    };
+
+    // Data blocks waiting for the worker threads
+    struct BlockQueue
+    {
+        DbLoader* loaderP;
+
+        Mutex mutex;
+        Condition taskReady;
+        Condition taskDone;
+
+        std::deque<BlockTask*> pending;
+
+        bool finished;
+    };
+
     static const string _LOG_FILE;
 
+    // Number of data blocks whose data is written out together in the
+    // block-streaming mode
+    static const unsigned int _STREAM_FLUSH_BLOCKS;
+
     string _workDir; // Working directory for all generated files.
     string _INPUT_FILE;
 
@@ -440,24 +681,67 @@ class DbLoader
 
     bool _firstDatablock;
 
+    // Number of threads of the block-streaming mode, 0 if disabled
+    unsigned int _streamThreads;
+
+    // Number of threads that map the tables of a block
+    unsigned int _tableThreads;
+
+    // Parse cache of ASCII input files, NULL if disabled
+    ParseCache* _parseCacheP;
+
     std::ofstream _log;
 
+    // Serializes schema mapping queries of concurrently converted blocks
+    // and tables
+    Mutex _schemaMutex;
+
     SchemaMap& _schemaMapping;
     DbOutput& _dbOutput;
 
-    void _LoadBlock(Block& rBlock, Block& wBlock);
+    void _LoadBlock(Block& rBlock, Block& wBlock, std::ostream& log,
+      std::ostream& err);
+
+    void _PrepareTable(TableTask& task, const unsigned int numTables,
+      Block& rBlock, Block& wBlock,
+      std::map<ISTable*, Mutex*>* sourceMutexesP);
+    void _MapTable(const string& blockName, TableTask& task,
+      BlockScratch& scratch);
+    void _MapTables(const string& blockName, vector<TableTask*>& tasks);
+
+    static void _DeleteMutexes(std::map<ISTable*, Mutex*>& mutexes);
+
+    static void* _TableWorker(void* workerP);
+    static bool _IsCostlier(const TableTask* firstP,
+      const TableTask* secondP);
 
     bool _Search(vector<vector<string> >& dMap, const unsigned int iAttr,
       ISTable* isTableP, const string& blockName,
       const vector<string>& cNameMap, const string& sItem,
-      const string& sCnd, const string& sFnct);
+      const string& sCnd, const string& sFnct, Mutex* sourceMutexP,
+      BlockScratch& scratch, std::ostream& log);
  
     void _DoFunc(vector<string>& s, const vector<string>& r,
-      const string& sFnct);
+      const string& sFnct, BlockScratch& scratch);
 
     void _OpenLog(const string& logName);
 
-    int _GetMapColumnIndex(const vector<string>& cNameMap, const string& vOf);
+    void _StreamFileToDb(const string& asciiFile, const eConvOpt convOpt,
+      const vector<string>& skipCatList);
+    CifFile* _ParseBlock(const string& blockText,
+      const vector<string>& skipCatList);
+    CifFile* _CreateWriteFile();
+    void _MapBlock(BlockTask& task);
+    void _MergeBlock(BlockQueue& queue, BlockTask& task, Block& wBlock,
+      const vector<string>& tList);
+    void _WriteStreamedData(Block& wBlock, const vector<string>& tList);
+    static void _ClearTables(Block& block, const vector<string>& tList);
+    void _StopWorkers(BlockQueue& queue, vector<pthread_t>& threads);
+
+    static void* _StreamWorker(void* queueP);
+
+    int _GetMapColumnIndex(const vector<string>& cNameMap, const string& vOf,
+      std::ostream& log);
     void _GetMapColumnValue(string& p, vector<string>& dMapVec,
       unsigned int irow);
 
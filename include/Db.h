@@ -47,6 +47,12 @@ class Db
     void SetAppendFlag(const bool appendFlag);
     bool GetAppendFlag();
 
+    void SetDeferIndex(bool mode=true);
+    bool GetDeferIndex();
+
+    void SetIndexJobs(const unsigned int indexJobs);
+    unsigned int GetIndexJobs();
+
     void SetFieldSeparator(const std::string& fieldSeparator);
     void SetRowSeparator(const std::string& rowSeparator);
 
@@ -99,6 +105,15 @@ class Db
       const vector<std::string>& indexList,
       const vector<string>& indexListTypes=vector<string>());
 
+    virtual void WriteTableEnd(std::ostream& io);
+    virtual void WriteCreateIndex(std::ostream& io,
+      const std::string& tableNameDb,
+      const vector<std::string>& indexList,
+      const vector<string>& indexListTypes=vector<string>());
+    virtual void WriteDropIndex(std::ostream& io,
+      const std::string& tableNameDb);
+    virtual bool IsParallelIndexSupported();
+
     const std::string& GetBcpStringDelimiter();
     virtual void WriteBcpDoubleQuotes(std::ostream& io);
 
@@ -117,6 +132,10 @@ class Db
 
     bool _appendFlag;
 
+    // Indexes are created after data loading, instead of with the tables
+    bool _deferIndex;
+    unsigned int _indexJobs; // Number of concurrent index creation jobs
+
     // Field and row separators for compact output (eg. BCP)
     std::string _fieldSeparator; 
     std::string _rowSeparator;   
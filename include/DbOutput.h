@@ -17,6 +17,7 @@
 
 #include <string>
 #include <vector>
+#include <map>
 #include <ostream>
 
 #include "Db.h"
@@ -45,13 +46,24 @@ class DbOutput
       std::string());
     virtual void WriteData(Block& block, const std::string& path =
       std::string());
+    virtual void WriteDataPart(Block& block, const std::string& path =
+      std::string());
+    virtual void DiscardDataParts();
+    virtual void SortData(const std::string& path = std::string(),
+      const unsigned long maxMemory = 0);
+    virtual void GetDataFileNames(std::vector<std::string>& fileNames,
+      const std::string& path = std::string());
 
     void SetInputFile(const std::string& inpFile);
 
+    bool GetAppendFlag();
+
     const std::string& GetCommandScriptName();
 
   protected:
     static const std::string _DATA_LOADING_SCRIPT;
+    static const std::string _INDEX_DROP_FILE;
+    static const std::string _INDEX_FILE;
 
     std::string _SCHEMA_FILE;
 
@@ -70,6 +82,13 @@ class DbOutput
       const unsigned int indentLevel = 0);
     void WriteDbExecOnly(std::ostream& io, const std::string& fileName,
       const unsigned int indentLevel = 1);
+    void WriteDbExecBackground(std::ostream& io,
+      const std::string& fileName);
+
+    void WriteIndexFiles(std::vector<std::string>& indexFileNames,
+      const std::string& workDir);
+    void WriteIndexCreation(std::ostream& io,
+      const std::vector<std::string>& indexFileNames);
 
     void WriteHeader(std::ostream& io);
 
@@ -83,6 +102,23 @@ class DbOutput
     void _FormatData(std::ostream& io, const std::string& cs,
       const unsigned int type, const unsigned int witdh);
 
+    // Writers of non-empty and of empty values of a column type
+    typedef void (DbOutput::*ValueWriter)(std::ostream& io,
+      const std::string& cs, const unsigned int maxWidth);
+    typedef void (DbOutput::*EmptyWriter)(std::ostream& io);
+
+    void _GetColumnWriters(ValueWriter& valueWriter, EmptyWriter& emptyWriter,
+      const eTypeCode typeCode);
+
+    void _WriteNumericValue(std::ostream& io, const std::string& cs,
+      const unsigned int maxWidth);
+    void _WriteStringValue(std::ostream& io, const std::string& cs,
+      const unsigned int maxWidth);
+    void _WriteTextValue(std::ostream& io, const std::string& cs,
+      const unsigned int maxWidth);
+    void _WriteDateValue(std::ostream& io, const std::string& cs,
+      const unsigned int maxWidth);
+
     bool IsSpecialChar(const char& character);
     bool IsSpecialDateChar(const char& character);
 
@@ -107,7 +143,23 @@ class DbOutput
       Block& block, const std::string& masterIndexAttribName,
       const std::vector<std::string>& tableNames);
 
+    void GetTableIndex(std::vector<std::string>& indexList,
+      std::vector<std::string>& indexListTypes, const std::string& tableName);
+
   protected:
+    // Data of one input file can be written in parts, with WriteDataPart()
+    // for all but the last part and WriteData() for the last one. These
+    // hold, per table, the master index value of its first row and the
+    // file its rows are written to, until the last part is written.
+    std::map<std::string, std::string> _partMasterIndexValues;
+    std::map<std::string, std::string> _partFileNames;
+
+    void _KeepPartMasterIndexValues(Block& block,
+      const std::string& masterIndexAttribName,
+      const std::vector<std::string>& tableNames);
+
+    void _WriteTableData(std::ostream& io, ISTable* t);
+
     virtual void _WriteTable(std::ostream& io, ISTable* tIn,
       std::vector<unsigned int>& widths,
       const bool reCalcWidth = false,
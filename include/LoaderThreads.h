@@ -0,0 +1,97 @@
+/*$$FILE$$*/
+/*$$VERSION$$*/
+/*$$DATE$$*/
+/*$$LICENSE$$*/
+
+
+/*!
+** \file LoaderThreads.h
+**
+** \brief Header file for thread synchronization classes of the loader.
+*/
+
+
+#ifndef LOADERTHREADS_H
+#define LOADERTHREADS_H
+
+
+#include <pthread.h>
+
+
+/**
+**  \class Mutex
+**
+**  \brief Mutual exclusion lock.
+**
+**  This class is a thin wrapper around a POSIX mutex.
+*/
+class Mutex
+{
+  public:
+    Mutex();
+    ~Mutex();
+
+    void Lock();
+    void Unlock();
+
+  private:
+    friend class Condition;
+
+    pthread_mutex_t _mutex;
+
+    Mutex(const Mutex& inMutex);
+    Mutex& operator=(const Mutex& inMutex);
+};
+
+
+/**
+**  \class MutexLock
+**
+**  \brief Scoped lock of a mutex.
+**
+**  This class locks the mutex on construction and unlocks it on
+**  destruction, so that the mutex is unlocked on every exit from a scope,
+**  including exceptions. If constructed with a NULL mutex, nothing is
+**  locked, which is used for data that is shared only in some modes.
+*/
+class MutexLock
+{
+  public:
+    MutexLock(Mutex& mutex);
+    MutexLock(Mutex* mutexP);
+    ~MutexLock();
+
+  private:
+    Mutex* _mutexP;
+
+    MutexLock(const MutexLock& inMutexLock);
+    MutexLock& operator=(const MutexLock& inMutexLock);
+};
+
+
+/**
+**  \class Condition
+**
+**  \brief Condition variable.
+**
+**  This class is a thin wrapper around a POSIX condition variable. Wait()
+**  must be called with the mutex locked.
+*/
+class Condition
+{
+  public:
+    Condition();
+    ~Condition();
+
+    void Wait(Mutex& mutex);
+    void Signal();
+    void Broadcast();
+
+  private:
+    pthread_cond_t _cond;
+
+    Condition(const Condition& inCondition);
+    Condition& operator=(const Condition& inCondition);
+};
+
+#endif
@@ -0,0 +1,83 @@
+/*$$FILE$$*/
+/*$$VERSION$$*/
+/*$$DATE$$*/
+/*$$LICENSE$$*/
+
+
+/*!
+** \file ParseCache.h
+**
+** \brief Header file for ParseCache class.
+*/
+
+
+#ifndef PARSECACHE_H
+#define PARSECACHE_H
+
+
+#include <sys/types.h>
+
+#include <string>
+#include <vector>
+
+#include "CifFile.h"
+
+
+/**
+**  \class ParseCache
+**
+**  \brief On-disk cache of parsed ASCII CIF files.
+**
+**  This class keeps serialized (binary) CIF file objects, obtained by
+**  parsing ASCII CIF files, in a cache directory, so that an unchanged
+**  file does not have to be parsed again. A cache entry is valid for the
+**  same file path, inode, file size, file modification time (with
+**  nanoseconds) and the same list of categories not parsed. Each entry
+**  consists of a serialized file (".odb") and a key file (".key") with the
+**  description of the parsed file. The total size of the serialized
+**  files is found once, when the cache is opened, and is then kept up to
+**  date. When it exceeds the maximum cache size, the least recently used
+**  entries are removed.
+*/
+class ParseCache
+{
+  public:
+    static const unsigned long DEFAULT_MAX_SIZE = 1024 * 1024 * 1024;
+
+    ParseCache(const std::string& cacheDir,
+      const unsigned long maxSize = DEFAULT_MAX_SIZE);
+    ~ParseCache();
+
+    CifFile* Get(const std::string& fileName,
+      const std::vector<std::string>& skipCatList, const bool verbose);
+    bool Put(CifFile& cifFile, const std::string& fileName,
+      const std::vector<std::string>& skipCatList);
+
+  private:
+    static const std::string _KEY_VERSION;
+
+    struct Entry
+    {
+        std::string name;
+        off_t size;
+        time_t lastUse;
+    };
+
+    std::string _cacheDir;
+    unsigned long _maxSize;
+
+    // Total size of the serialized files
+    unsigned long long _totalSize;
+
+    bool _GetKey(std::string& key, const std::string& fileName,
+      const std::vector<std::string>& skipCatList);
+    void _GetEntryName(std::string& entryName, const std::string& key);
+
+    void _Scan(std::vector<Entry>& entries);
+    void _Remove(const std::string& entryName);
+    void _Evict(const std::string& keepEntryName);
+
+    static bool _IsLessRecent(const Entry& first, const Entry& second);
+};
+
+#endif
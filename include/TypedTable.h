@@ -0,0 +1,67 @@
+/*$$FILE$$*/
+/*$$VERSION$$*/
+/*$$DATE$$*/
+/*$$LICENSE$$*/
+
+
+/*!
+** \file TypedTable.h
+**
+** \brief Header file for TypedTable class.
+*/
+
+
+#ifndef TYPEDTABLE_H
+#define TYPEDTABLE_H
+
+
+#include <string>
+#include <vector>
+
+#include "SchemaMap.h"
+
+
+/**
+**  \class TypedTable
+**
+**  \brief Typed, column-major view of a mapped table.
+**
+**  This class describes the valid rows of a mapped table column by column,
+**  without copying its values. Rows are validated once, when the view is
+**  constructed. For each column it holds the type code, the maximum value
+**  length and a bitmap of empty (NULL) values, all found in one pass over
+**  the column. Output formats use it to choose the formatting of each column
+**  once, instead of for every value.
+*/
+class TypedTable
+{
+  public:
+    TypedTable(ISTable& isTable, const std::vector<AttrInfo>& attrInfo,
+      const std::vector<eTypeCode>& typeCodes);
+    ~TypedTable();
+
+    unsigned int GetNumRows() const;
+    unsigned int GetNumColumns() const;
+
+    eTypeCode GetTypeCode(const unsigned int colI) const;
+    unsigned int GetMaxWidth(const unsigned int colI) const;
+
+    const std::vector<std::string>& GetRow(const unsigned int rowI);
+    bool IsNull(const unsigned int rowI, const unsigned int colI) const;
+
+  private:
+    ISTable& _isTable;
+
+    // Indices of the valid rows in the table
+    std::vector<unsigned int> _rows;
+
+    std::vector<eTypeCode> _typeCodes;
+
+    // Maximum length of the values of each column
+    std::vector<unsigned int> _maxWidths;
+
+    // Bit i of column j is set if the value of valid row i is empty (NULL)
+    std::vector<std::vector<unsigned char> > _nulls;
+};
+
+#endif
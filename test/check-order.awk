@@ -0,0 +1,68 @@
+#
+# Checks that the rows of BCP data are ordered on the index columns of
+# their table, as defined in the schema mapping file. Data must use the
+# '&##&\t' field and '$##$\n' row terminators.
+#
+# Usage: awk -v table=<table name> -f check-order.awk <mapping file> <data>
+#
+FNR == NR {
+    if ($0 ~ /^_rcsb_attribute_def\./) {
+        inDef = 1
+        next
+    }
+    if (inDef && ($0 ~ /^(#|loop_|_)/)) {
+        inDef = 0
+    }
+    if (inDef && ($1 == table)) {
+        ++nCols
+        if ($4 == 1) {
+            ++nKeys
+            keyCols[nKeys] = nCols
+            isNumeric[nKeys] = ($3 == "int" || $3 == "float")
+        }
+    }
+    next
+}
+{
+    sub(/\$##\$$/, "")
+    split($0, fields, /&##&\t/)
+
+    if (FNR > 1) {
+        for (keyI = 1; keyI <= nKeys; ++keyI) {
+            prev = prevFields[keyCols[keyI]] ""
+            curr = fields[keyCols[keyI]] ""
+
+            # Null values sort first
+            if (prev == "" || curr == "") {
+                if (prev == curr)
+                    continue
+                if (prev == "")
+                    break
+                print "Row " FNR " of " table " is out of order"
+                exit 1
+            }
+
+            if (isNumeric[keyI]) {
+                if (prev + 0 < curr + 0)
+                    break
+                if (prev + 0 > curr + 0) {
+                    print "Row " FNR " of " table " is out of order"
+                    exit 1
+                }
+            }
+            else {
+                if (prev < curr)
+                    break
+                if (prev > curr) {
+                    print "Row " FNR " of " table " is out of order"
+                    exit 1
+                }
+            }
+        }
+    }
+
+    for (colI in prevFields)
+        delete prevFields[colI]
+    for (colI in fields)
+        prevFields[colI] = fields[colI]
+}